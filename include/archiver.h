@@ -0,0 +1,58 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __ARCHIVER__
+
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+
+namespace TULESOFT {
+
+//!
+//! The <i>archiver</i> writes a directory tree to a compressed tar file (same as 'tar czf'), without running
+//! any external program. The tar file is streamed through the compressor as it is written. Supported codecs are
+//! <i>gzip</i> (zlib) and, if compiled with HAVE_ZSTD, <i>zstd</i>.
+//!
+
+class archiver {
+ public:
+  archiver(std::string _codec = "gzip", int _level = -1) : codec(_codec), level(_level), fd(-1), stream(NULL) {};
+  ~archiver();
+
+  //! Archive <i>dir_name</i> (a sub-directory of <i>parent_dir</i>) to <i>archive_path</i>. Paths in the archive
+  //! are relative to the parent directory. On failure returns false, with the reason in <i>error_msg</i>.
+  bool ArchiveDirectory(std::string parent_dir, std::string dir_name, std::string archive_path, std::string &error_msg);
+
+  //! File suffix to use for archives, ie, ".tar.gz".
+  static std::string suffix(std::string codec);
+  //! Returns true if a codec is supported. A level of -1 selects the codec default level.
+  static bool codec_supported(std::string codec, int level);
+
+ private:
+  bool add_tree(std::string path, std::string archive_name);
+  bool add_header(std::string archive_name, char type, const struct stat &sbuf, long long size, std::string link_name);
+  bool add_long_name(char type, std::string name);
+  bool add_file_data(std::string path, long long size);
+  bool write_block(const char *buf, size_t len);
+  bool write_padding(long long size);
+  bool open_stream(std::string archive_path);
+  bool compress(const char *buf, size_t len, bool finish);
+  void close_stream();
+  bool fail(std::string what, std::string path, int errnum);
+
+  std::string codec;
+  int         level;
+  int         fd;          // archive file
+  void       *stream;      // compressor state
+  std::vector<char> out_buffer;
+  std::string error;
+};
+
+};
+
+#endif
+#define __ARCHIVER__ 1
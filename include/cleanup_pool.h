@@ -0,0 +1,67 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __CLEANUP_POOL__
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+#include "job.h"
+#include "job_metrics.h"
+
+namespace TULESOFT {
+
+//!
+//! The <i>cleanup pool</i> is a small set of threads used to compress or remove passing job run directories (and
+//! to settle scratch directories, see <i>job::use_scratch_dir</i>), so that the servers that ran the jobs (or the
+//! supervisor) can go right on to the next job. The cleanup queue is bounded; if the
+//! cleanup threads fall behind, <i>Submit</i> blocks until there is room. Once a run directory has been compressed
+//! or removed, the submitter is called back (ie, to record the job outcome in the results journal).
+//!
+
+class cleanup_pool {
+ public:
+  cleanup_pool() : metrics(NULL), queue_limit(0), stopping(false), error_count(0) {};
+  ~cleanup_pool() {};
+
+  //! Start the cleanup threads. Time taken to compress or remove each run directory is recorded in <i>metrics</i>
+  //! (if not NULL).
+  void Start(int thread_count, job_metrics *metrics);
+  //! Queue up an ended job for cleanup (see <i>job::CleanupResults</i>), ie, compression or removal of its run directory. <i>on_cleaned</i> is called (from a
+  //! cleanup thread) once the run directory has been compressed or removed.
+  void Submit(job &the_request, std::function<void(job &)> on_cleaned);
+  //! Wait for all queued cleanups to complete, then stop the cleanup threads.
+  void Finish();
+
+  //! The # of run directories that could not be compressed or removed.
+  int ErrorCount() { return error_count; };
+  //! Reasons for (the first few) cleanup errors.
+  std::vector<std::string> Errors();
+
+ private:
+  void worker();
+
+  job_metrics             *metrics;
+  std::vector<std::thread> threads;
+  std::deque<std::pair<job,std::function<void(job &)> > > pending;
+  size_t                   queue_limit;
+  bool                     stopping;
+  std::mutex               pool_mutex;
+  std::condition_variable  not_empty;
+  std::condition_variable  not_full;
+  std::atomic<int>         error_count;
+  std::vector<std::string> errors;
+};
+
+};
+
+#endif
+#define __CLEANUP_POOL__ 1
@@ -0,0 +1,51 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __DISPATCH_QUEUE__
+
+#include <vector>
+#include <atomic>
+
+#include "job.h"
+#include "job_generator.h"
+
+namespace TULESOFT {
+
+//!
+//! The <i>dispatch queue</i> hands out jobs to servers. All jobs from all job generators are numbered consecutively,
+//! and the queue is simply the (atomic) number of the next job to hand out. Thus retreiving the next job requires no
+//! lock, and the queue size does not depend on the # of jobs. Jobs marked as done (see <i>job_generator::MarkDone</i>)
+//! are skipped over.
+//!
+
+class dispatch_queue {
+ public:
+  dispatch_queue() : total_count(0), done_count(0), next_job(0), skipped_count(0) {};
+  ~dispatch_queue() {};
+
+  //! Add the jobs from a job generator to the queue. All generators must be added before any jobs are retreived.
+  void Add(job_generator &generator);
+  //! Retreive the next job. Returns false if the queue is empty.
+  bool Next(job &next_job_request);
+  //! Remove all remaining jobs from the queue.
+  void Clear();
+  //! The # of jobs remaining in the queue.
+  long Size();
+  //! The job generators, in the order added.
+  const std::vector<job_generator> &Generators() const { return generators; };
+
+ private:
+  std::vector<job_generator> generators;
+  std::vector<long>          first_index;  // global # of the first job from each generator
+  long                       total_count;  // total # of jobs from all generators
+  long                       done_count;   // # of jobs to skip
+  std::atomic<long>          next_job;     // global # of next job to hand out
+  std::atomic<long>          skipped_count; // # of jobs skipped so far
+};
+
+};
+
+#endif
+#define __DISPATCH_QUEUE__ 1
@@ -5,6 +5,11 @@
 
 #ifndef __JOBCLASS__
 #include <string>
+#include <memory>
+
+#include "job_process.h"
+#include "output_capture.h"
+#include "job_outcome.h"
 
 namespace TULESOFT {
 
@@ -12,51 +17,143 @@ namespace TULESOFT {
 //! The <i>job</i> represents a single test to be verified..
 //!
 
+class job_generator;
+
 class job {
  public:
- job() : do_compress(false), do_remove(false) {};
+ job() : generator(NULL), index(-1), exit_code(-1), term_signal(0), launch_error(0), deadline(-1), timed_out(false),
+    launch_time(0), start_time(0), end_time(0), persisted(false), cached(false), cached_status(JOB_FAIL) {};
   ~job() {};
-  
- job(std::string _project_dir, std::string _run_dir, std::string _cmdline, int _job_id, bool _do_compress, bool _do_remove)
-   : project_dir(_project_dir), run_dir(_run_dir), cmdline(_cmdline), exit_code(-1), job_id(_job_id),
-    do_compress(_do_compress), do_remove(_do_remove) {
+
+  //! A job is identified by its job generator (expanded job submission) and index. All job parameters are
+  //! retreived from the generator on demand.
+ job(const job_generator *_generator, long _index)
+   : generator(_generator), index(_index), exit_code(-1), term_signal(0), launch_error(0), deadline(-1), timed_out(false),
+    launch_time(0), start_time(0), end_time(0), persisted(false), cached(false), cached_status(JOB_FAIL) {
   };
 
   //! The project directory name is formed from the project-name and unit-name.
-  std::string ProjectDir() { return project_dir; };
+  std::string ProjectDir();
   //! For each invocation of <b>focus_js</b>, all individual jobs runs have an assigned and unique <i>rrun-directory</i> name.
-  std::string RunDir() { return run_dir; };
+  std::string RunDir();
   //! The full path to a jobs run directory.
   std::string RunDirPath() { return rundir_path; };
   //! The complete job <i>command line</i> used to execute a job.
-  std::string CommandLine() { return cmdline; };
+  std::string CommandLine();
+  //! The job index, ie, the job # within its job submission.
+  long Index() { return index; };
+  //! The job submission ID (see <i>job_generator::SubmissionId</i>).
+  int SubmissionId();
   //! Returns true if a job directory may be compressed upon successful execution.
-  bool Compress() { return do_compress; };
+  bool Compress();
   //! Returns true if a job directory may be removed upon successful execution.  
-  bool Remove() { return do_remove; };
+  bool Remove();
+  //! Returns true if, once the job has ended, there is cleanup to be done (see <i>CleanupResults</i>, <i>cleanup_pool</i>):
+  //! the job passed and its run directory is to be compressed or removed, or the job was run in a scratch directory.
+  bool CleanupNeeded();
+  //! Returns true if the job command line is to be run via /bin/sh, instead of being exec'd directly.
+  bool UseShell();
   //! The <i>Run</i> does just what its name implies. It runs the job. All job output is collected in the job <i>RunDir</i>.
   void Run();
-  //! After a job is run, this method may be used to compress (tar/gzip) the run directory.
-  int CompressResults();
-  //! After a job is run, this method may be used to remove the run directory.
-  int RemoveResults();
-  //! The ExitCode methods returns the outcome of a jobs execution. A system call is used for execution. The <i>exit code</i>
-  //! reflects the system call exit code.
+  //! <i>Start</i> creates the run directory and starts the job process, but does not wait for the process to end. Returns
+  //! false if the job could not be started (the job is then complete, see <i>LaunchError</i>), or if the job outcome
+  //! was found in the result cache (the job is then complete, see <i>Cached</i>).
+  bool Start();
+  //! Check if a started job has ended (or wait for it to end if <i>block</i> is true). Once the job ends, its exit code
+  //! and terminating signal (if any) are recorded and true is returned. If the job has a timeout, a blocking wait
+  //! kills the job when the timeout expires.
+  bool Finish(bool block);
+  //! If the job has a timeout, the time (see <i>monotonic_ms</i>) at which the job must next be checked, else -1.
+  long long Deadline() { return deadline; };
+  //! Called when the job deadline passes. The first call terminates the job (SIGTERM), a second call (if the job
+  //! still hasn't ended) kills it (SIGKILL).
+  void Expire();
+  //! The job outcome: pass, fail, or killed due to timeout or resource limit.
+  job_status Status();
+  //! The job outcome, as recorded in the results journal.
+  job_outcome Outcome();
+  //! Resources used by the job. Valid once the job has ended.
+  job_usage Usage();
+  //! When (see <i>monotonic_us</i>) <i>Start</i> was called, ie, when the job launch began.
+  long long LaunchTime() { return launch_time; };
+  //! When the job process was started (or the launch failed).
+  long long StartTime() { return start_time; };
+  //! When the job process was found to have ended.
+  long long EndTime() { return end_time; };
+  //! The job process, valid after the job has been started.
+  job_process &Process() { return process; };
+  //! Once a job has ended: settle its scratch directory (if run in one, see <i>use_scratch_dir</i>), then compress or
+  //! remove its run directory (if it passed, as requested). Returns non-zero on failure, with the reason in
+  //! <i>error_msg</i>.
+  int CleanupResults(std::string &error_msg);
+  //! After a job is run, this method may be used to compress (tar/gzip or tar/zstd) the run directory. Returns
+  //! non-zero on failure, with the reason in <i>error_msg</i>.
+  int CompressResults(std::string &error_msg);
+  //! After a job is run, this method may be used to remove the run directory. Returns non-zero on failure, with the
+  //! reason in <i>error_msg</i>.
+  int RemoveResults(std::string &error_msg);
+  //! The file suffix for a compressed run directory, ie, ".tar.gz".
+  std::string ArchiveSuffix();
+  //! The ExitCode methods returns the outcome of a jobs execution, ie, the exit code of the job process. If the process
+  //! was killed by a signal, the <i>exit code</i> is 128 + the signal number (same as the shell).
   int ExitCode() { return exit_code; };
+  //! The signal that terminated the job process, or zero if the process exited normally.
+  int TermSignal() { return term_signal; };
+  //! If the job process could not be started, the errno value recorded, else zero.
+  int LaunchError() { return launch_error; };
+  //! Returns true if the job outcome came from the result cache, ie, the job was not run.
+  bool Cached() { return cached; };
+  //! If the result cache is in use, add the outcome of the job (once the run directory has been compressed, if
+  //! requested). Outcomes of jobs that timed out, hit a limit, or were killed are not added. Returns false (with
+  //! <i>error_msg</i> set) if the outcome could not be added.
+  bool CacheOutcome(std::string &error_msg);
+
+  //! Run all jobs in <i>scratch</i> directories created under <i>root</i> (ie, on tmpfs), with stdout/stderr captured
+  //! in memory (the last <i>output_limit</i> bytes of each). Once a job ends, its scratch directory and output are
+  //! copied to its run directory if it failed, or if it is one of the <i>pass_sample</i> (0 to 1) fraction of passes
+  //! to be kept; otherwise the scratch directory is removed, and nothing is written to the output directory. This is
+  //! done by <i>CleanupResults</i> (on a cleanup thread), so that ending jobs are not held up. Returns
+  //! false w/ reason in <i>error_msg</i> if the scratch directory can't be used.
+  static bool use_scratch_dir(std::string root, double pass_sample, long long output_limit, std::string &error_msg);
 
  private:
-  std::string project_dir;  // rooted path to project output directory
-  std::string run_dir;      // name to use for job run directory
-  std::string cmdline;      // command line to be executed.
-  int         job_id;       // numeric job ID
-  bool        do_compress;  // if true, tar/zip run dir, then remove same
-  bool        do_remove;    // if true, remove (passing test) run dir
+  const job_generator *generator;  // expanded job submission this job comes from
+  long                 index;      // job # within the job submission
   
   // using input paths, job forms, then creates run-directory. heres the rooted path:
   
   std::string rundir_path;
+
+  job_process process;
   
   int exit_code;
+  int term_signal;
+  int launch_error;
+
+  long long deadline;   // when to next check on the job, if it has a timeout
+  bool      timed_out;  // true if the job has been terminated due to timeout
+
+  long long launch_time;  // job timeline (see monotonic_us): launch begun,
+  long long start_time;   //   job process started,
+  long long end_time;     //   job process ended
+
+  // scratch directory (see use_scratch_dir):
+
+  bool settle_scratch(std::string &error_msg);
+  bool sampled();
+
+  std::string                     scratch_path;  // where the job is run, if in a scratch directory
+  std::shared_ptr<output_capture> capture;       // job stdout/stderr, if in a scratch directory
+  bool                            persisted;     // scratch directory copied to the run directory
+
+  // result cache:
+
+  bool use_cached_outcome();
+
+  std::string cache_key;      // result cache key (if caching)
+  bool        cached;         // outcome from the result cache:
+  job_status  cached_status;  //
+  job_usage   cached_usage;   //
 };
 
 };
@@ -0,0 +1,56 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __JOB_CLIENT__
+
+#include <string>
+#include <vector>
+
+#include "job_submission.h"
+
+namespace TULESOFT {
+
+//!
+//! The <i>job client</i> talks to a <i>job daemon</i> (see job_daemon.h) over its unix domain socket: submit job
+//! submissions (a project run), query project runs, cancel a project run. Each request is a single connection:
+//!
+//!     SUBMIT <priority> <submission count>     followed by one (encoded) job submission per line
+//!     QUERY [<run id>]
+//!     CANCEL <run id>
+//!
+//! The daemon replies <i>OK [...]</i> or <i>ERROR <message></i>. A query reply is preceded by one <i>RUN</i> line
+//! per project run.
+//!
+
+class job_client {
+ public:
+  job_client(std::string _socket_path) : socket_path(_socket_path) {};
+  ~job_client() {};
+
+  //! Submit job submissions (all for the same project) to the daemon, to be run at <i>priority</i>. Returns zero
+  //! if the submissions were accepted.
+  int Submit(std::vector<job_submission> &submissions, int priority);
+  //! Display the state of project run <i>run_id</i>, or of all project runs (<i>run_id</i> -1).
+  int Query(int run_id);
+  //! Cancel project run <i>run_id</i>: jobs not yet started are discarded.
+  int Cancel(int run_id);
+
+  //! Encode a job submission as a single line. Relative paths (output directory, run script, files pattern) are
+  //! made absolute, since the daemon's working directory is not that of the client.
+  static std::string encode_submission(const job_submission &submission);
+  //! Decode a job submission encoded via <i>encode_submission</i>. Returns false if the line is garbled.
+  static bool decode_submission(std::string line, job_submission &submission);
+
+ private:
+  //! Send a request, read the reply (lines up to and including the <i>OK</i> or <i>ERROR</i> line).
+  bool request(std::vector<std::string> &request_lines, std::vector<std::string> &reply_lines);
+
+  std::string socket_path;
+};
+
+};
+
+#endif
+#define __JOB_CLIENT__ 1
@@ -0,0 +1,132 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __JOB_DAEMON__
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include "job.h"
+#include "job_submission.h"
+#include "dispatch_queue.h"
+#include "cleanup_pool.h"
+#include "results_journal.h"
+
+namespace TULESOFT {
+
+//!
+//! A <i>project run</i> is the set of job submissions (for one project) submitted to a job daemon in one request.
+//! Each project run has its own job queue, pass/fail counts, fails threshhold, results journal and pass/fail
+//! summary report, just as for a sweep run by <i>job_server</i>.
+//!
+
+class project_run {
+ public:
+  project_run(int _id, int _priority) : id(_id), priority(_priority), fails_threshhold(-1), job_count(0), pass(0),
+    outstanding(0), cancelled(false), finished(false), done_count(0), pass_count(0), fail_count(0) {};
+  ~project_run() {};
+
+  //! Returns true if jobs from this project run may be started: jobs remain, and the project run has not been
+  //! cancelled or aborted (fails threshhold exceeded, results journal could not be written).
+  bool Runnable();
+  //! Returns true if the fails threshhold was exceeded, or the results journal could not be written.
+  bool Aborted();
+  //! State, for display: running, done, cancelled, aborted, interrupted.
+  std::string State();
+
+  int              id;                // project run id, ie, for query/cancel
+  int              priority;          // share of the job servers, relative to other project runs
+  std::string      project_dir_path;  // output-dir/project
+  int              fails_threshhold;  // smallest of the submissions fails threshholds, or -1
+  long             job_count;         // total # of jobs
+  dispatch_queue   requests;          // jobs yet to be run
+  results_journal  journal;           // project-dir/results_journal.txt
+
+  // scheduling state. guarded by the daemon mutex:
+
+  unsigned long long pass;            // stride scheduling: 'virtual time' of this project run
+  int              outstanding;       // jobs started but not yet recorded in the journal
+  bool             cancelled;
+  bool             finished;          // journal closed, report written (or being written)
+  std::string      final_state;
+
+  std::atomic<int> done_count;        // updated as jobs complete
+  std::atomic<int> pass_count;        //
+  std::atomic<int> fail_count;        //
+};
+
+//!
+//! The <i>job daemon</i> is a persistent job server: job submissions are accepted from <i>job clients</i> (see
+//! job_client.h) over a unix domain socket, and run on a single pool of job servers shared by all project runs.
+//! Project runs share the job servers in proportion to their priorities (stride scheduling): each time a job is
+//! started, the runnable project run that has had the least share so far (relative to its priority) is picked.
+//! Fails threshholds apply per project run. The daemon runs until it receives SIGINT or SIGTERM; running jobs
+//! are then allowed to finish, and project runs not yet done are recorded as <i>interrupted</i>. Only requests from
+//! the user running the daemon are accepted (jobs run as that user).
+//!
+
+class job_daemon {
+ public:
+  job_daemon(std::string _socket_path, int _thread_count, int _cleanup_thread_count)
+    : socket_path(_socket_path), thread_count(_thread_count), cleanup_thread_count(_cleanup_thread_count),
+    next_run_id(1), stopping(false) {};
+  ~job_daemon() {};
+
+  //! Run the daemon: listen for requests, run jobs, until SIGINT or SIGTERM is received. Returns zero, or -1 if
+  //! the daemon could not be started.
+  int Run();
+
+  //! The default socket: focus_js.sock in $XDG_RUNTIME_DIR, else in /tmp/focus_js-<i>uid</i> (created by the daemon,
+  //! accessible to the current user only).
+  static std::string default_socket();
+
+ private:
+  //! Handle one client connection (a single request).
+  void serve_connection(int fd);
+  //! Set up a new project run from job submissions. Returns the reply to send.
+  std::string submit(std::vector<job_submission> &submissions, int priority);
+  //! Reply (lines) for a query, of one (<i>run_id</i>) or all project runs.
+  std::vector<std::string> query(int run_id);
+  //! Cancel a project run. Returns the reply to send.
+  std::string cancel(int run_id);
+
+  //! Each job server runs jobs until the daemon is stopped.
+  void server();
+  //! Pick the next job to run (daemon mutex held). Returns false if no project run is runnable.
+  bool next_job(std::shared_ptr<project_run> &run, job &next_job_request);
+  //! Record the results of a job that has ended; compress or remove the job directory (if requested).
+  void complete_job(std::shared_ptr<project_run> run, job &the_job);
+  //! Record the outcome of a job in the project run results journal. Once all jobs are done, finish the project run.
+  void record_outcome(std::shared_ptr<project_run> run, job &the_job);
+  //! If no more jobs will be recorded for a project run, mark it finished (daemon mutex held). If <i>stopping_now</i>
+  //! is set the project run is finished even though jobs remain. Returns true if the caller is then to call
+  //! <i>finish_run</i>.
+  bool check_finished(std::shared_ptr<project_run> &run, bool stopping_now);
+  //! Close the results journal for a project run, write its pass/fail summary report.
+  void finish_run(std::shared_ptr<project_run> run);
+
+  std::string socket_path;
+  int thread_count;
+  int cleanup_thread_count;
+
+  std::mutex daemon_mutex;                         // guards project runs, scheduling state
+  std::condition_variable work_cv;                 // signaled when jobs are submitted, or daemon stopping
+  std::vector<std::shared_ptr<project_run> > runs; // all project runs, in order submitted
+  int next_run_id;
+  bool stopping;
+
+  std::vector<std::thread> servers;
+  cleanup_pool cleanups;
+};
+
+};
+
+#endif
+#define __JOB_DAEMON__ 1
@@ -0,0 +1,101 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __JOB_GENERATOR__
+
+#include <string>
+#include <vector>
+
+#include "job_submission.h"
+#include "result_cache.h"
+
+namespace TULESOFT {
+
+//!
+//! A <i>job generator</i> records an expanded <i>job submission</i>: the unit directory, resolved run-script path,
+//! options, and list of input files. The individual jobs are not created up front. Instead each job is identified
+//! by its <i>index</i> (0 to <i>JobCount</i> - 1), and the job run-directory name and command line are formed from
+//! the index only when the job is about to run.
+//!
+
+class job_generator {
+ public:
+  job_generator() : submission_id(-1), done_count(0), resuming(false), caching(false) {};
+  ~job_generator() {};
+
+  job_generator(int _submission_id, std::string _unit_dir_path, std::string _run_script_path,
+                std::vector<std::string> &_files_list, job_submission &_submission)
+    : submission_id(_submission_id), unit_dir_path(_unit_dir_path), run_script_path(_run_script_path),
+    files_list(_files_list), submission(_submission), done_count(0), resuming(false), caching(false) {
+    // having the files-list have at least one entry makes the job index logic easier...
+    if (files_list.size() == 0)
+      files_list.push_back("");
+  };
+
+  //! Total # of jobs: the run count times the # of input files.
+  long JobCount() const { return (long) submission.RunCount() * files_list.size(); };
+
+  //! The unit directory (output-dir/project/unit/date) - all job run directories are created here.
+  std::string UnitDirPath() const { return unit_dir_path; };
+  //! The (rooted) run-script path.
+  std::string RunScriptPath() const { return run_script_path; };
+  //! The input file paths (a single empty entry if none).
+  const std::vector<std::string> &Files() const { return files_list; };
+  //! The run-directory name for a job.
+  std::string RunDir(long index) const;
+  //! The command line for a job: run-script, options, input file (if any).
+  std::string CommandLine(long index) const;
+  //! The job ID for a job, passed to the job via the JOB_ID environment variable. The job ID is the run #.
+  int JobId(long index) const { return index / files_list.size(); };
+
+  //! The job submission the jobs come from, ie, for run options.
+  const job_submission &Submission() const { return submission; };
+  //! The job submission ID: 0 for the first submission, 1 for the 2nd, etc.
+  int SubmissionId() const { return submission_id; };
+
+  //! When resuming an interrupted sweep, jobs that already ran are marked as done, and will be skipped.
+  void MarkDone(long index);
+  //! Returns true if the job is to be skipped.
+  bool Done(long index) const { return (done.size() > 0) && done[index]; };
+  //! The # of jobs marked as done.
+  long DoneCount() const { return done_count; };
+  //! Returns true if this generator is resuming an interrupted sweep (and thus may find leftover run directories).
+  bool Resuming() const { return resuming || (done.size() > 0); };
+  //! Expect leftover run directories even though no jobs are marked as done, ie, when resuming a sweep interrupted
+  //! before any job outcome was recorded, or on a worker, which may be handed jobs re-queued from a lost worker.
+  void SetResuming() { resuming = true; };
+
+  //! Look up/add job outcomes in <i>cache</i>. <i>script_digest</i> is the digest of the run script contents.
+  void EnableCache(const result_cache &_cache, std::string _script_digest) {
+    cache = _cache; script_digest = _script_digest; caching = true;
+  };
+  //! Returns true if the result cache is in use.
+  bool Caching() const { return caching; };
+  //! The result cache.
+  const result_cache &Cache() const { return cache; };
+  //! The run script contents digest (if caching).
+  std::string ScriptDigest() const { return script_digest; };
+  //! The result cache key for a job: digest of run script, options, input file contents, job ID, limits. Returns
+  //! false if the key cannot be formed (input file cannot be read).
+  bool CacheKey(long index, std::string &key) const;
+
+ private:
+  int submission_id;                    // submission # (order of submission)
+  std::string unit_dir_path;            // rooted path to unit directory
+  std::string run_script_path;          // rooted path to run script
+  std::vector<std::string> files_list;  // input file paths (or single empty entry)
+  job_submission submission;            // run count, options, etc.
+  std::vector<bool> done;               // jobs to skip (empty unless resuming)
+  long done_count;
+  bool resuming;                        // leftover run directories expected?
+  bool caching;                         // result cache in use?
+  result_cache cache;                   //
+  std::string script_digest;            // run script contents digest (if caching)
+};
+
+};
+
+#endif
+#define __JOB_GENERATOR__ 1
@@ -0,0 +1,117 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __JOB_METRICS__
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <memory>
+
+namespace TULESOFT {
+
+//!
+//! A <i>latency histogram</i> records durations (in microseconds) into logarithmic buckets - eight buckets per
+//! power of two - so that percentiles may be estimated (to within about 10%) using a small, fixed amount of memory.
+//! Recording a duration requires no lock.
+//!
+
+class latency_histogram {
+ public:
+  latency_histogram();
+  ~latency_histogram() {};
+
+  //! Record a duration, in microseconds.
+  void Record(long long usecs);
+
+  //! The # of durations recorded.
+  long long Count() { return count; };
+  //! The sum of all durations recorded, in microseconds.
+  long long Total() { return total; };
+  //! The longest duration recorded, in microseconds.
+  long long Max() { return max; };
+  //! Estimate the duration (in microseconds) below which <i>percent</i> % of the recorded durations fall.
+  long long Percentile(double percent);
+  //! Summary, as a JSON object: count, total, mean, median, 90th/99th percentile, max (times in milliseconds).
+  std::string Json();
+
+ private:
+  static const int BUCKETS = 320;
+
+  static int bucket(long long usecs);
+  static long long bucket_limit(int index);
+
+  std::atomic<long long> buckets[BUCKETS];
+  std::atomic<long long> count;
+  std::atomic<long long> total;
+  std::atomic<long long> max;
+};
+
+//!
+//! <i>Job metrics</i> are gathered as jobs are launched, end, and are cleaned up: job latency (wall time) by unit,
+//! time spent launching jobs vs compressing/removing passing job directories, dispatch latency (time from a job
+//! ending to the next job being launched in its place), time to first job. The metrics are written periodically
+//! to a (JSON) metrics file, so that a sweep may be monitored as it runs.
+//!
+
+class job_metrics {
+ public:
+  job_metrics() : start_time(0), first_launch(-1), running(0), last_write(0), last_done(0) {};
+  ~job_metrics() {};
+
+  //! Add a unit, ie, job submission. All units must be added before jobs are run.
+  void AddUnit(int submission_id, std::string unit);
+  //! Mark the start of the sweep.
+  void Start();
+
+  //! A job is being launched...
+  void JobLaunching() { running++; };
+  //! A job was launched: <i>launch_time</i> is the time (see <i>monotonic_us</i>) at which the job was
+  //! launched, <i>launch_usecs</i> the time taken to create the run directory and start the job process.
+  void JobLaunched(long long launch_time, long long launch_usecs);
+  //! A job (from job submission <i>submission_id</i>) ended, after running for <i>wall_usecs</i>.
+  void JobEnded(int submission_id, long long wall_usecs);
+  //! Time taken from one job ending until the next job was launched in its place.
+  void DispatchLatency(long long usecs) { dispatch.Record(usecs); };
+  //! Time taken to compress or remove a passing job directory.
+  void Cleanup(long long usecs) { cleanup.Record(usecs); };
+
+  //! # of jobs running.
+  int Running() { return running; };
+  //! Job wall time, for all units.
+  latency_histogram &WallTime() { return all_jobs; };
+
+  //! Write the metrics file (written to a temp file, then renamed, so that the file is always complete). Returns
+  //! false if the file could not be written.
+  bool Write(std::string path, long queued, int done, int passed, int failed, bool final);
+  //! Write the metrics file, if at least <i>interval_ms</i> milliseconds have passed since it was last written.
+  bool WriteIfDue(std::string path, long queued, int done, int passed, int failed, long long interval_ms = 1000);
+
+ private:
+  struct unit_metrics {
+    int submission_id;
+    std::string unit;
+    std::unique_ptr<latency_histogram> wall_time;
+  };
+
+  std::vector<unit_metrics> units;
+
+  latency_histogram all_jobs;     // job wall time (all units)
+  latency_histogram launch;       // mkdir + vfork/exec
+  latency_histogram cleanup;      // compress/remove
+  latency_histogram dispatch;     // job end to next launch
+
+  long long              start_time;
+  std::atomic<long long> first_launch;
+  std::atomic<int>       running;
+
+  long long last_write;           // when metrics file last written, and # of jobs done
+  int       last_done;            //   as of then (for recent jobs/sec)
+};
+
+};
+
+#endif
+#define __JOB_METRICS__ 1
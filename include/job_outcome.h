@@ -7,25 +7,89 @@
 
 #include <string>
 
+//!
+//! The outcome of a job: pass (exit code of zero) or fail, or the job was killed because it exceeded its time or
+//! resource limits.
+//!
+
+enum job_status { JOB_PASS, JOB_FAIL, JOB_TIMEOUT, JOB_CPU_LIMIT, JOB_MEM_LIMIT };
+
+//!
+//! Resources used by a job (the job process and its descendants), as reported by <i>wait4</i>, plus wall time.
+//!
+
+struct job_usage {
+  job_usage() : wall_usecs(0), user_usecs(0), system_usecs(0), max_rss_kb(0), in_blocks(0), out_blocks(0),
+    voluntary_switches(0), involuntary_switches(0) {};
+
+  long long wall_usecs;            // job launch to job end
+  long long user_usecs;            // user cpu time
+  long long system_usecs;          // system cpu time
+  long      max_rss_kb;            // max resident set size
+  long      in_blocks;             // file system input, output
+  long      out_blocks;            //   (512 byte blocks)
+  long      voluntary_switches;    // context switches
+  long      involuntary_switches;  //
+};
+
 //!
 //! After a job runs, a <i>job outcome</i> class instance is used to record a brief summary..
-//! All <i>job outcomes</i> are recorded. After all jobs have been run, a brief pass/fail summary
-//! report will be created, using the vector of <i>job outcomes</i>.
+//! All <i>job outcomes</i> are recorded in the <i>results journal</i>. After all jobs have been run, a brief
+//! pass/fail summary report is created from the journal.
 //!
 
 class job_outcome {
  public:
-  job_outcome() : do_compress(false), do_remove(false) {};
+  job_outcome() : submission_id(-1), index(-1), exit_code(-1), status(JOB_FAIL), do_compress(false), do_remove(false),
+    cached(false) {};
   ~job_outcome() {};
 
   //! Job servers use this constructor after a job ends, to record exit-code, run-dir path, dispensation.. 
-  job_outcome(int _exit_code, std::string _run_dir, std::string _run_dir_path, bool _do_compress, bool _do_remove)
-   : exit_code(_exit_code), run_dir(_run_dir), run_dir_path(_run_dir_path),
-    do_compress(_do_compress), do_remove(_do_remove) {};
+  job_outcome(int _submission_id, long _index, int _exit_code, job_status _status, std::string _run_dir,
+	      std::string _run_dir_path, bool _do_compress, bool _do_remove, std::string _archive_suffix = ".tar.gz",
+	      job_usage _usage = job_usage(), bool _cached = false)
+   : submission_id(_submission_id), index(_index), exit_code(_exit_code), status(_status), run_dir(_run_dir),
+    run_dir_path(_run_dir_path), do_compress(_do_compress), do_remove(_do_remove), archive_suffix(_archive_suffix),
+    usage(_usage), cached(_cached) {};
 
-  //! The job was run via <i>system</i> call. This method returns the system call exit code.
+  //! The job submission (0 for the first submission, 1 for the 2nd, etc.) the job came from.
+  int SubmissionId() { return submission_id; };
+
+  //! The job index, ie, the job # within its job submission.
+  long Index() { return index; };
+
+  //! This method returns the job process exit code (128 + signal # if the process was killed by a signal).
   int ExitCode() { return exit_code; };
 
+  //! The job outcome: pass, fail, timeout, etc.
+  job_status Status() { return status; };
+
+  //! Returns true if the job passed.
+  bool Passed() { return status == JOB_PASS; };
+
+  //! The job outcome, as it appears in the pass/fail summary report: PASS, FAIL, TIMEOUT, CPU_LIMIT, MEM_LIMIT.
+  static std::string status_name(job_status status) {
+    switch(status) {
+      case JOB_PASS:      return "PASS";
+      case JOB_TIMEOUT:   return "TIMEOUT";
+      case JOB_CPU_LIMIT: return "CPU_LIMIT";
+      case JOB_MEM_LIMIT: return "MEM_LIMIT";
+      default:            return "FAIL";
+    }
+  };
+
+  //! Convert a status name (see <i>status_name</i>) back to a job status. Returns false if the name is not recognized.
+  static bool status_from_name(std::string name, job_status &status) {
+    const job_status all_status[] = { JOB_PASS, JOB_FAIL, JOB_TIMEOUT, JOB_CPU_LIMIT, JOB_MEM_LIMIT };
+    for (unsigned int i = 0; i < sizeof(all_status) / sizeof(all_status[0]); i++) {
+       if (name == status_name(all_status[i])) {
+	 status = all_status[i];
+	 return true;
+       }
+    }
+    return false;
+  };
+
   //! The full path of the job run directory.
   std::string RunDirPath() { return run_dir_path; };
   
@@ -37,13 +101,29 @@ class job_outcome {
 
   //! Returns true if the run directory is to be removed on good exit code.
   bool Remove() { return do_remove; }; 
+
+  //! File suffix of the compressed run directory, ie, ".tar.gz".
+  std::string ArchiveSuffix() { return archive_suffix; };
+
+  //! Resources used by the job: wall time, cpu time, memory, I/O, context switches.
+  const job_usage &Usage() { return usage; };
+
+  //! Returns true if the outcome came from the result cache (the job was not run). Resources are then those used
+  //! when the job was run.
+  bool Cached() { return cached; };
   
  private:
+  int submission_id;
+  long index;
   int exit_code;
+  job_status status;
   std::string run_dir;
   std::string run_dir_path;
   bool do_compress;
   bool do_remove;
+  std::string archive_suffix;
+  job_usage usage;
+  bool cached;
 };
 
 #endif
@@ -0,0 +1,112 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __JOB_PROCESS__
+
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+namespace TULESOFT {
+
+//!
+//! Resource limits applied to a job process. A zero value means no limit.
+//!
+
+class process_limits {
+ public:
+  process_limits() : max_rss(0), max_cpu_seconds(0) {};
+  process_limits(long long _max_rss, int _max_cpu_seconds) : max_rss(_max_rss), max_cpu_seconds(_max_cpu_seconds) {};
+
+  //! Memory limit in bytes. Enforced via cgroup (memory.max); requires a cgroup (see <i>job_process::use_cgroup</i>).
+  long long MaxRss() const { return max_rss; };
+  //! CPU time limit in seconds. Enforced via RLIMIT_CPU.
+  int MaxCpuSeconds() const { return max_cpu_seconds; };
+  //! Returns true if any limits are set.
+  bool Any() const { return (max_rss > 0) || (max_cpu_seconds > 0); };
+
+ private:
+  long long max_rss;
+  int       max_cpu_seconds;
+};
+
+//!
+//! A <i>job process</i> is the operating system process used to execute a single job. The process is started
+//! directly (vfork/exec) - no intervening shell is used unless <i>shell mode</i> is requested. The job ID is
+//! passed via the JOB_ID environment variable, and stdout/stderr are redirected to files in the run directory (or to
+//! descriptors supplied by the caller, ie, pipes - see <i>output_capture</i>).
+//! A process with resource limits or a timeout is started in its own process group (and, if enabled, its own
+//! cgroup), so that the process and any processes it starts may be killed together.
+//!
+
+class job_process {
+ public:
+  job_process() : pid(-1), own_group(false), exit_code(-1), term_signal(0), launch_error(0), oom_killed(false), usage() {};
+  ~job_process() {};
+
+  //! Start the process. In <i>native</i> mode the command line is split into words (single/double quotes and
+  //! backslash escapes are honored) and the first word is exec'd. In <i>shell</i> mode the command line is
+  //! passed to /bin/sh -c. Returns false if the process could not be started (see <i>LaunchError</i>).
+  //! If <i>own_group</i> is set, the process is started in a new process group. If <i>stdout_fd</i> and <i>stderr_fd</i>
+  //! are given, they become the process' stdout/stderr, instead of runlog.stdout/runlog.stderr in the run directory.
+  bool Spawn(std::string run_dir_path, std::string cmdline, int job_id, bool use_shell,
+	     bool _own_group = false, process_limits limits = process_limits(), int stdout_fd = -1, int stderr_fd = -1);
+  //! Wait for the process to exit, then record its exit code or terminating signal.
+  void Wait() { Reap(true); };
+  //! Check if the process has exited (or wait for it to exit if <i>block</i> is true). Returns true once the process
+  //! has been reaped and its exit code or terminating signal recorded.
+  bool Reap(bool block);
+  //! Wait up to <i>timeout_ms</i> milliseconds for the process to exit. Returns true if the process has been reaped.
+  bool WaitFor(int timeout_ms);
+  //! Send a signal to the running process (and to its process group and cgroup, if it has its own).
+  void Kill(int sig);
+  //! Open a <i>pidfd</i> for the running process. The pidfd becomes readable when the process exits, and may be
+  //! used with poll/epoll. Returns -1 if pidfds are not supported (Linux 5.3 or later). Caller closes the fd.
+  int OpenPidFd();
+
+  //! Process ID of the running process, or -1.
+  pid_t Pid() { return pid; };
+  //! Exit code of the process. If the process was terminated by a signal, 128 + signal # (same as the shell).
+  int ExitCode() { return exit_code; };
+  //! The signal that terminated the process, or zero if the process exited normally.
+  int TermSignal() { return term_signal; };
+  //! errno value recorded if the process could not be started, else zero.
+  int LaunchError() { return launch_error; };
+  //! Returns true if the process was killed by the cgroup memory limit.
+  bool OomKilled() { return oom_killed; };
+  //! Resource usage of the process (valid once the process has been reaped).
+  const struct rusage &Usage() { return usage; };
+
+  //! Run all job processes w/ resource limits in their own cgroup, created under <i>root</i> (a cgroup v2
+  //! directory delegated to the user). Returns false w/ reason in <i>error_msg</i> if the cgroup can't be used.
+  static bool use_cgroup(std::string root, std::string &error_msg);
+  //! Returns false w/ reason in <i>error_msg</i> if <i>limits</i> can't be enforced, ie, a memory limit w/o a cgroup.
+  static bool check_limits(const process_limits &limits, std::string &error_msg);
+
+  //! Split a command line into words, using (simplified) shell quoting rules. No variable or wildcard
+  //! expansion is performed.
+  static bool split_cmdline(std::vector<std::string> &words, std::string cmdline);
+
+ private:
+  void record_status(int wstatus);
+  void remove_cgroup();
+
+  pid_t pid;
+  bool  own_group;
+  std::string cgroup_path;  // the cgroup for this process, if any
+  int   exit_code;
+  int   term_signal;
+  int   launch_error;
+  bool  oom_killed;
+  struct rusage usage;
+};
+
+};
+
+#endif
+#define __JOB_PROCESS__ 1
@@ -11,6 +11,11 @@
 #include "job.h"
 #include "job_outcome.h"
 #include "job_submission.h"
+#include "job_generator.h"
+#include "dispatch_queue.h"
+#include "cleanup_pool.h"
+#include "results_journal.h"
+#include "job_metrics.h"
 
 namespace TULESOFT {
 
@@ -31,6 +36,17 @@ class server {
     //! This method causes a single job to be executed, records the results,
     //! and optionally causes the job directory to be compressed or removed.
     void service_request(job &the_request);
+
+    //! Retreive (and remove) the next job from the job queue. Returns false if the queue is empty, or
+    //! if no more jobs are to be run (user typed <i>ctrl-C</i>, or the fails threshhold was exceeded).
+    static bool next_request(job &next_job_request);
+    //! Record the results of a job that has ended, and optionally cause the job directory to be compressed
+    //! or removed.
+    static void complete_request(job &the_request);
+    //! Record the outcome of a job in the results journal, once the job directory has been dealt with.
+    static void record_outcome(job &the_request);
+    //! Returns true if all servers are to stop picking up jobs.
+    static bool aborting();
     
   private:
     int id;
@@ -43,11 +59,16 @@ class server {
  
 class job_server {
   public:
- job_server() : thread_count(-1), fails_threshhold(-1) {};
+ job_server() : thread_count(-1), fails_threshhold(-1), event_driven(false), kill_on_abort(false),
+    cleanup_thread_count(2), resume(false), coordinator_port(-1) {};
   ~job_server() {};
 
-  //! Start up a <i>job server</i> using a set of job submissions, and (optionally) a thread count. 
-  job_server(std::vector<job_submission> &submissions,int _thread_count) : thread_count(_thread_count) {
+  //! Start up a <i>job server</i> using a set of job submissions, and (optionally) a thread count. If <i>resume</i>
+  //! is set, the same job submissions were run before but the sweep was interrupted: the results journal from
+  //! the interrupted sweep is used to pick up where the sweep left off.
+  job_server(std::vector<job_submission> &submissions,int _thread_count,bool _resume = false)
+    : thread_count(_thread_count), fails_threshhold(-1), event_driven(false), kill_on_abort(false), cleanup_thread_count(2),
+    resume(_resume), coordinator_port(-1) {
     init(submissions);
   };
 
@@ -56,8 +77,35 @@ class job_server {
   //! (vector) of job submissions.
   static int process_submissions_file(std::vector<TULESOFT::job_submission> &my_submissions,std::string submissions_file);
 
+  //! Create a job generator for a job submission (resolves the run-script path, expands the files pattern). Job run
+  //! directories are created under <i>unit_dir_path</i>. Throws <i>std::runtime_error</i> if the run-script path
+  //! cannot be resolved.
+  static job_generator create_generator(job_submission &submission,int submission_id,std::string unit_dir_path);
+  //! Combine two fails threshholds (-1 meaning no threshhold): the smaller of the two is used.
+  static int combine_fails_threshholds(int threshhold, int other_threshhold);
+  //! Write the pass/fail summary report (csv) <i>report_path</i>, from results journal <i>journal_path</i>.
+  //! Returns false if the journal could not be read.
+  static bool write_pass_fail_report(std::string journal_path, std::string report_path);
+
   //! After creating an instance of the server, all one need do is call Run.
   int Run(); 
+  //! By default each job is run on its own (server) thread. In <i>event driven</i> mode, a single thread
+  //! supervises all running jobs (the thread count is then the number of jobs to keep running), and
+  //! starts the next job as soon as any job ends.
+  void SetEventDriven(bool _event_driven) { event_driven = _event_driven; };
+  //! In <i>event driven</i> mode, if set, running jobs are terminated when the user types <i>ctrl-C</i>
+  //! or the fails threshhold is exceeded. Otherwise running jobs are allowed to finish.
+  void SetKillOnAbort(bool _kill_on_abort) { kill_on_abort = _kill_on_abort; };
+  //! The # of threads used to compress or remove passing job directories (default 2).
+  void SetCleanupThreads(int _cleanup_thread_count) { cleanup_thread_count = _cleanup_thread_count; };
+  //! Instead of running jobs, act as <i>coordinator</i>: listen on TCP <i>port</i> (on the interface with
+  //! <i>bind_address</i>, '*' for all) for <i>workers</i> (see job_worker.h), hand out jobs to them in batches, and
+  //! record the job outcomes they send back. Only workers that present <i>token</i> (a shared secret) are accepted.
+  void SetCoordinator(int port, std::string bind_address, std::string token) {
+    coordinator_port = port;
+    coordinator_bind_address = bind_address;
+    coordinator_token = token;
+  };
   //! Used to cause all servers running to shut down. This could occur due to the user typing <i>ctrl-C</i>, or
   //! (unbelievable as it might be) due to some internal error detected.
   static void shut_down_handler(int s);
@@ -67,9 +115,12 @@ class job_server {
   void init(std::vector<job_submission> &submissions);
   //! Evaluating a <i>job submission</i> could result in one or more individual verification jobs being run. This
   //! method is used to evaluate and as a result expand a <i>job submission</i> into a set of jobs to be run.
-  void expand_submission(job_submission &submissions);
+  void expand_submission(job_submission &submissions,int submission_id);
+  //! When resuming, read the results journal from the interrupted sweep: the unit directories used, and the jobs
+  //! already done.
+  void read_journal();
   //! This method will evaluate a file-pattern and produce a set of file-paths.
-  bool expand_filelist(std::vector<std::string> &files_list,std::string pattern);
+  static bool expand_filelist(std::vector<std::string> &files_list,std::string pattern);
   //! This method is used to reset (unfortunately) some global variables necessary for multi-thread coordination.
   void reset_globals();
   //! This method is used to evaluate all job submissions.
@@ -77,10 +128,20 @@ class job_server {
   //! 
   void service_job_requests();
   void run_all_jobs(int thread_count_to_use);
+  //! Single threaded alternative to <i>run_all_jobs</i>: keep up to <i>slot_count</i> jobs running, using
+  //! pidfd/signalfd/epoll to react to job completion or interrupt.
+  void supervise_all_jobs(int slot_count);
+  //! Alternative to <i>run_all_jobs</i>: hand out jobs to workers, record the outcomes they send back. Re-queue the
+  //! jobs of a lost worker. Once no jobs remain to hand out, take back jobs not yet started from the most loaded
+  //! worker for a worker with free slots (work stealing).
+  void coordinate_all_jobs();
+  //!
+  static void show_progress(int num_done, int run_count);
 
-  void generate_reports(std::vector<job_outcome> &results);
+  //! Create the pass/fail summary report, from the results journal.
+  void generate_reports();
 
-  void queue_up_request(job my_request);
+  void queue_up_requests(job_generator &generator);
 
   int QueuedCount();
 
@@ -93,6 +154,25 @@ class job_server {
   int thread_count;
 
   int fails_threshhold;
+
+  bool event_driven;
+
+  bool kill_on_abort;
+
+  int cleanup_thread_count;
+
+  bool resume;
+
+  int coordinator_port;                               // if coordinating workers, the port to listen on,
+  std::string coordinator_bind_address;               //   the interface to listen on,
+  std::string coordinator_token;                      //   the token workers must present
+
+  std::string journal_path;                           // results journal, in project directory
+  std::string metrics_path;                           // metrics file, ditto
+  std::vector<journal_submission> journal_submissions; // unit dir, # of jobs for each submission
+  std::vector<int> new_submissions;                   // submissions not yet recorded in the journal
+  std::vector<std::vector<bool> > resumed_done;        // jobs already done, by submission (if resuming)
+  int resumed_passes, resumed_fails, resumed_timeouts, resumed_limits;
   
   // used to create a succinct and unique ID for each task:
   
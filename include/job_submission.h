@@ -6,6 +6,7 @@
 #ifndef __JOB_SUBMISSION__
 
 #include <string>
+#include <stdexcept>
 
 namespace TULESOFT {
 
@@ -16,7 +17,8 @@ namespace TULESOFT {
 
 class job_submission {
  public:
- job_submission() : run_count(1), compress_passes(false), remove_passes(false) {};
+ job_submission() : run_count(1), compress_passes(false), remove_passes(false), fail_threshhold(-1), use_shell(false),
+    compress_codec("gzip"), compress_level(-1), timeout(0), max_rss(0), max_cpu_seconds(0), cache(false) {};
   ~job_submission() {};
 
   job_submission(std::string _output_directory, std::string _project, std::string _unit, 
@@ -24,7 +26,9 @@ class job_submission {
                  int _run_count, bool _compress_passes, bool _remove_passes, int _fail_threshhold)
     : output_directory(_output_directory), project(_project), unit(_unit), run_script(_run_script),
     files_pattern(_files_pattern), options(_options), run_count(_run_count),
-    compress_passes(_compress_passes), remove_passes(_remove_passes), fail_threshhold(_fail_threshhold) {
+    compress_passes(_compress_passes), remove_passes(_remove_passes), fail_threshhold(_fail_threshhold),
+    use_shell(false), compress_codec("gzip"), compress_level(-1), timeout(0), max_rss(0), max_cpu_seconds(0),
+    cache(false) {
 
     if (compress_passes && remove_passes)
       throw std::logic_error("job_submission: compress_passes and remove_passes cannot both be set.");
@@ -32,30 +36,59 @@ class job_submission {
 
   //! The <i>main</i> output directory name or path. All project run directories are created as sub-directories of
   //! the <i>output directory</i>..
-  std::string OutputDirectory() { return output_directory; };
+  std::string OutputDirectory() const { return output_directory; };
   //! The <i>project name</i>. Also, a sub-directory of the <i>output directory</i>.
-  std::string Project() { return project; };
+  std::string Project() const { return project; };
   //! All jobs are grouped together in <i>unit</i> sub-directories underneath the <i>project directory</i>.
-  std::string Unit() { return unit; };
+  std::string Unit() const { return unit; };
   //! The <i>run script</i> represents a test tool executable or shell script, and presumably some verification process.
-  std::string RunScript() { return run_script; };
+  std::string RunScript() const { return run_script; };
   //! The (optional) <i>file pattern</i> is evaluated when each <i>job submission</i> is processed, to yield a list
   //! of files. 
-  std::string FilesPattern() { return files_pattern; };
+  std::string FilesPattern() const { return files_pattern; };
   //! The <i>options</i> string records any command line options to be passed to the <i>run script</i>, when each individual
   //! job is run.
-  std::string Options() { return options; };
+  std::string Options() const { return options; };
   //! A <i>run count</i> is associated with a job-submission. Each individual job resulting from evaluating a <i>job submission</i>
   //! will be run multiple times, according to the <i>run count</i>.
-  int RunCount() { return run_count; };
+  int RunCount() const { return run_count; };
   //! <i>Compress</i> returns true if a (passing test) job directory may be compressed (tar'd/gzip'ed) after execution.
-  bool Compress() { return compress_passes; };
+  bool Compress() const { return compress_passes; };
   //! <i>Remove</i> returns true if a (passing test) job directory may be removed after execution. 
-  bool Remove() { return remove_passes; };
+  bool Remove() const { return remove_passes; };
   //! A <i>fails threshhold</i> is associated with a job-submission. If at any point the fails threshhold (total # of fails)
   //! is met or exceeded, all remaining jobs (jobs not yet picked up by some server) are discarded and execution halts.
-  //! NOTE: In current implementation there is only a single project wide fail threshhold.
-  int FailThreshhold() { return fail_threshhold; };
+  //! The fails threshhold applies project wide; if job submissions for the same project specify different thresholds,
+  //! the smallest is used. -1 means no threshhold.
+  int FailThreshhold() const { return fail_threshhold; };
+
+  //! By default each job is started directly (no shell). <i>UseShell</i> returns true if instead the job command line
+  //! is to be run via /bin/sh, for run scripts or options that depend on shell expansion.
+  bool UseShell() const { return use_shell; };
+  void SetUseShell(bool _use_shell) { use_shell = _use_shell; };
+
+  //! The compression <i>codec</i> (gzip or zstd) to use when compressing passing job directories.
+  std::string CompressCodec() const { return compress_codec; };
+  //! The compression level to use, or -1 for the codec default.
+  int CompressLevel() const { return compress_level; };
+  void SetCompression(std::string _codec, int _level) { compress_codec = _codec; compress_level = _level; };
+
+  //! The wall-clock <i>timeout</i> (in seconds) for each job, or zero for no timeout. A job that runs past its timeout
+  //! is sent SIGTERM (then SIGKILL, if need be), and is recorded as a TIMEOUT.
+  double Timeout() const { return timeout; };
+  //! Memory limit (in bytes) for each job, or zero for no limit.
+  long long MaxRss() const { return max_rss; };
+  //! CPU time limit (in seconds) for each job, or zero for no limit.
+  int MaxCpuSeconds() const { return max_cpu_seconds; };
+  void SetLimits(double _timeout, long long _max_rss, int _max_cpu_seconds) {
+    timeout = _timeout; max_rss = _max_rss; max_cpu_seconds = _max_cpu_seconds;
+  };
+
+  //! If <i>Cache</i> returns true, job outcomes are looked up in (and added to) the <i>result cache</i> for the output
+  //! directory: a job whose run script, options, input file and job ID are unchanged since it was last run is not
+  //! run again. Use only for deterministic jobs.
+  bool Cache() const { return cache; };
+  void SetCache(bool _cache) { cache = _cache; };
 
  private:
   std::string output_directory;        // output directory
@@ -68,6 +101,13 @@ class job_submission {
   bool        compress_passes;         // tar/zip then remove passing rub-directories
   bool        remove_passes;           // just remove passing rub-directories
   int         fail_threshhold;         // fails threshhold - remaining jobs aborted when threshhold reached for a unit
+  bool        use_shell;               // run job command lines via /bin/sh
+  std::string compress_codec;          // gzip or zstd
+  int         compress_level;          // compression level, -1 for default
+  double      timeout;                 // per-job wall clock timeout, seconds
+  long long   max_rss;                 // per-job memory limit, bytes
+  int         max_cpu_seconds;         // per-job cpu time limit, seconds
+  bool        cache;                   // use result cache
 };
  
 };
@@ -0,0 +1,100 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __JOB_WORKER__
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "job.h"
+#include "job_generator.h"
+#include "cleanup_pool.h"
+#include "line_channel.h"
+
+namespace TULESOFT {
+
+//!
+//! A <i>job worker</i> runs jobs handed out by a <i>coordinator</i> (a <b>focus_js</b> started with the coordinator
+//! option, see <i>job_server::SetCoordinator</i>), over TCP. The coordinator expands the job submissions; workers (on
+//! any number of machines sharing the output file system) run the jobs, compress or remove passing job directories,
+//! and send back each job outcome, which the coordinator records in its results journal.
+//!
+//! Each worker keeps up to twice its slot count of jobs on hand, asking for more (in batches) once half have been
+//! used up. When the coordinator has no jobs left to hand out, a worker with free slots gets jobs taken back from
+//! the most loaded worker (jobs it has on hand but has not started). Jobs handed to a worker that is lost (connection
+//! dropped, no keepalive reply, or too far behind in reading what the coordinator sends) are handed out again.
+//!
+//! A worker must first say HELLO, with the token (shared secret, see <i>read_token_file</i>) the coordinator was
+//! given; otherwise the coordinator drops the connection. Lines are not encrypted: coordinator and workers are
+//! to talk over a trusted network.
+//!
+//! Protocol (line channel, one line per message):
+//!
+//!     worker:       HELLO <slots> <host> <token>            coordinator: SUBMISSION, FILE lines, then READY
+//!     worker:       WORK <count>                            ask for (count) more jobs
+//!     coordinator:  JOBS <submission id> <index> ...        jobs to run (a batch, maybe less than asked for)
+//!     coordinator:  STEAL <count>                           hand back up to (count) jobs not yet started...
+//!     worker:       RETURN <submission id> <index> ...      ...which are
+//!     worker:       RESULT <results journal record>         job outcome
+//!     worker:       ERROR <message>                         job directory could not be compressed/removed/saved
+//!     coordinator:  DONE                                    no more jobs: finish running jobs, then disconnect
+//!
+//! The SUBMISSION line for each job submission: submission id, unit directory, run script path, run script digest,
+//! # of FILE lines (input files) to follow, and the (encoded, see <i>job_client::encode_submission</i>) job submission.
+//!
+
+class job_worker {
+ public:
+  job_worker(std::string _coordinator_address, std::string _token, int _slot_count, int _cleanup_thread_count)
+    : coordinator_address(_coordinator_address), token(_token), slot_count(_slot_count),
+    cleanup_thread_count(_cleanup_thread_count),
+    running(0), stopping(false), event_fd(-1), pass_count(0), fail_count(0) {};
+  ~job_worker() {};
+
+  //! Connect to the coordinator (<i>host:port</i>), run jobs until the coordinator says there are no more. Returns
+  //! zero, or -1 if the worker could not connect, or lost its connection to the coordinator.
+  int Run();
+
+ private:
+  //! Read the job submissions from the coordinator, create a job generator for each. Any lines read past the end
+  //! of the job submissions are left in <i>lines</i>.
+  bool read_setup(line_channel &channel, std::vector<std::string> &lines);
+  //! Each server runs jobs from the worker's backlog.
+  void server();
+  //! Queue up the outcome of a job (run directory compressed or removed, if requested), to be sent.
+  void job_ended(job &the_job);
+  //! Discard jobs not yet started.
+  void clear_backlog();
+
+  std::string coordinator_address;
+  std::string token;                   // shared secret, presented to the coordinator in HELLO
+  int slot_count;
+  int cleanup_thread_count;
+
+  std::vector<job_generator> generators;  // one per job submission, by submission id
+
+  std::mutex worker_mutex;             // guards backlog, running, stopping, outbox
+  std::condition_variable work_cv;     // signaled when jobs are added to the backlog, or stopping
+  std::deque<job> backlog;             // jobs handed to this worker, not yet started
+  int running;                         // jobs started, outcome not yet queued to be sent
+  bool stopping;
+  std::vector<std::string> outbox;     // messages to send (from server, cleanup threads)
+  int event_fd;                        // wakes the main thread when the outbox is added to
+
+  int pass_count;                      // jobs run (outcome sent), guarded as for outbox
+  int fail_count;                      //
+
+  std::vector<std::thread> servers;
+  cleanup_pool cleanups;
+};
+
+};
+
+#endif
+#define __JOB_WORKER__ 1
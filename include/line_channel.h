@@ -0,0 +1,80 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __LINE_CHANNEL__
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace TULESOFT {
+
+//!
+//! A <i>line channel</i> exchanges newline terminated requests/replies over a (stream) socket. Fields within a line
+//! are tab separated; <i>escape</i> is used so that field values may contain tabs, newlines. The channel does not
+//! own the socket - the socket is closed via <i>Close</i>.
+//!
+
+class line_channel {
+ public:
+  line_channel() : fd(-1) {};
+  line_channel(int _fd) : fd(_fd) {};
+  ~line_channel() {};
+
+  //! Read the next line (without the newline). Returns false on end of file or error.
+  bool ReadLine(std::string &line);
+  //! Read whatever data is available (a single read, ie, once poll says the socket is readable), adding the complete
+  //! lines read to <i>lines</i>. Returns false on end of file or error.
+  bool ReadLines(std::vector<std::string> &lines);
+  //! Write a line (the newline is added). Returns false if the line could not be written.
+  bool WriteLine(std::string line);
+  //! Queue a line (the newline is added) to be sent w/o blocking: as much as the socket will take is sent now, the
+  //! rest by <i>Flush</i> (once poll says the socket is writable). Returns false on error.
+  bool QueueLine(std::string line);
+  //! Send as much of the queued data as the socket will take, w/o blocking. Returns false on error.
+  bool Flush();
+  //! The # of bytes queued, not yet sent.
+  size_t Pending() const { return out_buffer.size(); };
+  //! Close the socket.
+  void Close();
+  //! The socket.
+  int Fd() const { return fd; };
+
+  //! Escape tabs, newlines, backslashes within a field value.
+  static std::string escape(std::string field);
+  //! Undo <i>escape</i>.
+  static std::string unescape(std::string field);
+  //! Split a line into its (tab separated) fields, unescaping each.
+  static std::vector<std::string> split(std::string line);
+  //! Join fields into a line, escaping each.
+  static std::string join(const std::vector<std::string> &fields);
+
+  //! Create, bind, listen on a unix domain socket. A stale socket file (no one listening) is replaced. The socket
+  //! file is made accessible to its owner only. Returns the socket, or -1 (with <i>error_msg</i> set) on error.
+  static int listen_unix(std::string path, std::string &error_msg);
+  //! Returns true if the process at the other end of a (connected) unix domain socket runs as the same user as we
+  //! do; sets <i>peer_uid</i>.
+  static bool same_user(int fd, uid_t &peer_uid);
+  //! Connect to a unix domain socket. Returns the socket, or -1 (with <i>error_msg</i> set) on error.
+  static int connect_unix(std::string path, std::string &error_msg);
+  //! Create, bind, listen on a TCP socket, on the interface with <i>address</i> (a host name or IP address; '*' for
+  //! all interfaces). Returns the socket, or -1 (with <i>error_msg</i> set) on error.
+  static int listen_tcp(std::string address, int port, std::string &error_msg);
+  //! Connect to a TCP socket, <i>host:port</i>. Returns the socket, or -1 (with <i>error_msg</i> set) on error.
+  static int connect_tcp(std::string host_and_port, std::string &error_msg);
+  //! Enable keepalive on a (connected) TCP socket, so that a peer whose machine has gone down is noticed within a
+  //! minute or so; send each line right away (no Nagle delay).
+  static void keep_alive(int fd);
+
+ private:
+  int fd;
+  std::string buffer;      // data read but not yet returned
+  std::string out_buffer;  // data queued but not yet sent
+};
+
+};
+
+#endif
+#define __LINE_CHANNEL__ 1
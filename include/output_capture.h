@@ -0,0 +1,83 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __OUTPUT_CAPTURE__
+
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+
+namespace TULESOFT {
+
+//!
+//! A <i>ring buffer</i> holds the last (up to) <i>capacity</i> bytes written to it. Older output is dropped.
+//!
+
+class ring_buffer {
+ public:
+  ring_buffer(size_t _capacity) : capacity(_capacity), start(0), total(0) {};
+  ~ring_buffer() {};
+
+  //! Add output. If the buffer is full, the oldest output is overwritten.
+  void Append(const char *data, size_t count);
+  //! The output held, oldest first.
+  std::string Contents() const;
+  //! The # of bytes written to the buffer, including those since dropped.
+  long long Total() const { return total; };
+  //! The # of (oldest) bytes dropped.
+  long long Dropped() const { return total - (long long) buffer.size(); };
+
+ private:
+  size_t      capacity;
+  std::string buffer;     // grows to capacity, then wraps
+  size_t      start;      // oldest byte, once buffer has wrapped
+  long long   total;
+};
+
+//!
+//! An <i>output capture</i> collects a job process' stdout/stderr via pipes, into a pair of ring buffers, instead of
+//! having the job write log files. The pipes of all running jobs are drained by a single capture thread (started
+//! when first needed), so that a job is never held up by a full pipe, whether or not its server is waiting on it.
+//!
+
+class output_capture : public std::enable_shared_from_this<output_capture> {
+ public:
+  output_capture(size_t limit) : stdout_ring(limit), stderr_ring(limit), open_count(0), detached(false) {
+    read_fds[0] = read_fds[1] = -1;
+  };
+  ~output_capture();
+
+  //! Create the pipes. The write ends (close-on-exec) are to become the job process' stdout/stderr. Returns false
+  //! (with errno set) if the pipes could not be created.
+  bool Open(int &stdout_fd, int &stderr_fd);
+  //! Begin draining the pipes. The caller closes its copies of the write ends (once the job process has them)
+  //! first, so that end-of-file is seen when the job process (and any process it started) exits.
+  bool Start();
+  //! Wait (up to <i>timeout_ms</i> milliseconds) for end-of-file on both pipes, then stop capturing. Any output
+  //! arriving after that (from stray background processes) is discarded.
+  void Finish(int timeout_ms);
+  //! Write the captured output to <i>dir</i>/runlog.stdout and <i>dir</i>/runlog.stderr. If output was dropped, the
+  //! file starts with a line saying so. Returns false w/ reason in <i>error_msg</i> on failure.
+  bool Write(std::string dir, std::string &error_msg);
+
+  //! Called from the capture thread: drain a pipe (0 - stdout, 1 - stderr). Returns false at end-of-file.
+  bool drain(int stream);
+
+ private:
+  ring_buffer stdout_ring;
+  ring_buffer stderr_ring;
+
+  int  read_fds[2];         // read ends of the stdout, stderr pipes
+  std::mutex capture_mutex; // guards the ring buffers, open_count, detached
+  std::condition_variable eof_cv;
+  int  open_count;          // # of pipes not yet at end-of-file
+  bool detached;            // capture finished; discard further output
+};
+
+};
+
+#endif
+#define __OUTPUT_CAPTURE__ 1
@@ -0,0 +1,72 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __RESULT_CACHE__
+
+#include <string>
+
+#include "job_outcome.h"
+
+namespace TULESOFT {
+
+//!
+//! A <i>cache entry</i> records the outcome of a job, as found in the <i>result cache</i>.
+//!
+
+struct cache_entry {
+  cache_entry() : status(JOB_FAIL), exit_code(-1) {};
+
+  job_status  status;
+  int         exit_code;
+  job_usage   usage;            // resources used when the job was run
+  std::string disposition;      // kept, compressed, removed
+  std::string archive_suffix;   // if compressed, ie, ".tar.gz"
+  std::string run_dir_path;     // if kept, the (rooted) run directory
+};
+
+//!
+//! The <i>result cache</i> records job outcomes by <i>key</i> - a digest (SHA-256) of everything a deterministic job
+//! depends on: run script contents, options, input file contents, job ID, limits. A job whose key is found in the
+//! cache need not be run again. For compressed passing jobs, the archived run directory is kept in the cache too.
+//!
+//! The cache is a directory (one per output directory) of entry files, named by key. Entries and archives are
+//! written to a temp file, then renamed, so that any number of focus_js runs may read and add to the cache at once:
+//! readers see a complete entry or none at all.
+//!
+
+class result_cache {
+ public:
+  result_cache() {};
+  result_cache(std::string _cache_dir) : cache_dir(_cache_dir) {};
+  ~result_cache() {};
+
+  //! The cache directory.
+  std::string Dir() const { return cache_dir; };
+  //! Look up a job outcome. Returns false if not found (or the entry is garbled).
+  bool Lookup(const std::string &key, cache_entry &entry) const;
+  //! Add a job outcome. If <i>archive_path</i> is not empty, the archived run directory is added too (hard linked if
+  //! possible, else copied). Returns false (with <i>error_msg</i> set) if the outcome could not be added.
+  bool Store(const std::string &key, const cache_entry &entry, std::string archive_path, std::string &error_msg) const;
+  //! Place the archived run directory for <i>key</i> at <i>dest_path</i>. Returns false if not possible.
+  bool RetrieveArchive(const std::string &key, std::string archive_suffix, std::string dest_path) const;
+
+  //! SHA-256 digest (hex) of a string.
+  static std::string digest(const std::string &data);
+  //! SHA-256 digest (hex) of a files contents. Returns false if the file cannot be read.
+  static bool digest_file(std::string path, std::string &file_digest);
+  //! The default cache directory for an output directory.
+  static std::string default_dir(std::string output_directory) { return output_directory + "/.focus_js_cache"; };
+
+ private:
+  //! Path of the entry file for a key (entries are spread over 256 sub-directories).
+  std::string entry_path(const std::string &key) const;
+
+  std::string cache_dir;
+};
+
+};
+
+#endif
+#define __RESULT_CACHE__ 1
@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------
+// Copyright  © 2017,2018 Tuleta Software, Inc.
+// (Reference ../docs/focus_js_license.html)
+//-----------------------------------------------------------------------
+
+#ifndef __RESULTS_JOURNAL__
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+#include "job_outcome.h"
+
+namespace TULESOFT {
+
+//!
+//! Each job submission recorded in a results journal: the # of jobs and the unit directory the jobs run in.
+//!
+
+struct journal_submission {
+  journal_submission() : job_count(0) {};
+  journal_submission(long _job_count, std::string _unit_dir_path) : job_count(_job_count), unit_dir_path(_unit_dir_path) {};
+
+  long        job_count;
+  std::string unit_dir_path;
+};
+
+//!
+//! The <i>results journal</i> is an append-only text file (in the project directory) that records each job
+//! submission, then the outcome of each job as the job completes (after its run directory has been compressed or
+//! removed). Records are written in batches, each batch followed by fdatasync, so that at most a second or so of
+//! job outcomes are lost if <b>focus_js</b> is killed. An interrupted sweep may then be resumed: jobs already
+//! recorded in the journal are not run again. The pass/fail summary report is created by reading the journal.
+//!
+//! Journal records, one per line, fields separated by tabs:
+//!
+//!     S  submission-id  job-count  unit-dir-path
+//!     D  submission-id  job-index  status  exit-code  kept|compressed|removed  archive-suffix  wall-usecs  user-usecs
+//!        system-usecs  max-rss-kb  in-blocks  out-blocks  voluntary-switches  involuntary-switches  run|cached  run-dir
+//!
+
+class results_journal {
+ public:
+  results_journal() : fd(-1), pending_records(0), last_sync(0), failed(false) {};
+  ~results_journal();
+
+  //! Create the journal (replacing any existing journal), or if <i>append</i> is set, open an existing journal
+  //! to add to. Returns false (with the reason in <i>error_msg</i>) if the journal cannot be opened.
+  bool Open(std::string path, bool append, std::string &error_msg);
+  //! Record a job submission. Job submissions must be recorded before any of their jobs.
+  void AddSubmission(int submission_id, const journal_submission &submission);
+  //! Record the outcome of a job. May be called from any thread.
+  void Append(job_outcome &outcome);
+  //! Write out any buffered records, then fdatasync.
+  void Sync();
+  //! Sync, then close the journal.
+  void Close();
+  //! Returns true if the journal could not be written.
+  bool Failed() { return failed; };
+  //! The reason the journal could not be written.
+  std::string Error();
+
+  //! Read a journal: the job submissions are returned via <i>submissions</i> (indexed by submission ID) and each
+  //! job outcome is passed to <i>on_outcome</i>, in the order recorded. An incomplete or garbled record (ie, the
+  //! last record written before a crash) is ignored. Returns false if the journal cannot be read.
+  static bool read(std::string path, std::vector<journal_submission> &submissions,
+		   std::function<void(job_outcome &)> on_outcome);
+  //! The journal record (without the newline) for a job outcome, ie, to pass a job outcome from one focus_js to
+  //! another.
+  static std::string outcome_record(job_outcome &outcome);
+  //! Parse a job outcome record (see <i>outcome_record</i>), given the job submissions. Returns false if the record
+  //! is garbled, or is not for one of the job submissions.
+  static bool parse_outcome_record(const std::string &record, const std::vector<journal_submission> &submissions,
+				   job_outcome &outcome);
+
+ private:
+  void write_out(std::string &records);
+
+  std::string path;
+  int         fd;
+  std::string buffer;           // records not yet written
+  int         pending_records;  // # of records in buffer
+  long long   last_sync;        // when journal was last synced (see monotonic_ms)
+  std::atomic<bool> failed;
+  std::string error;
+  std::mutex  buffer_mutex;     // guards buffer
+  std::mutex  file_mutex;       // serializes writes/syncs
+};
+
+};
+
+#endif
+#define __RESULTS_JOURNAL__ 1
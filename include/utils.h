@@ -5,12 +5,23 @@
 
 #ifndef __XTRA_UTILS__
 
+#include <string>
+#include <sys/types.h>
+
 // some convenient functions:
 
 namespace TULESOFT {
   
 std::string todays_date();
 void make_run_dir(std::string rdir, std::string rdir_desc);
+bool remove_dir_tree(std::string rdir, std::string &error_msg);
+bool copy_file(std::string from_path, std::string to_path, mode_t mode = 0666);
+bool copy_dir_tree(std::string from_dir, std::string to_dir, std::string &error_msg);
+bool make_private_dir(std::string dir, std::string &error_msg);
+bool read_token_file(std::string path, bool create, std::string &token, std::string &error_msg);
+long long monotonic_ms();
+long long monotonic_us();
+long long parse_size(std::string size_str);
 
 };
 
@@ -0,0 +1,132 @@
+#!/bin/sh
+
+# bench.sh - measure the overhead of focus_js itself (queue, launch, cleanup), by running synthetic
+#            workloads at various job and thread counts. Results are read from the metrics file
+#            focus_js writes at the end of each run, and appended to a csv file, so that results
+#            from different builds may be compared.
+#
+# Workloads:
+#
+#     true        - /bin/true
+#     sleep       - sleep for a fixed time (BENCH_SLEEP seconds, default 0.01)
+#     big_output  - write 1 MB to stdout
+#     fail        - /bin/false (failing job directories are kept, so BENCH_MAX_FAIL_JOBS limits the job count)
+#
+# Environment variables (defaults in parens):
+#
+#     BENCH_SIZES          - job counts ("1000 100000 1000000")
+#     BENCH_THREADS        - thread counts ("1 4 16 64")
+#     BENCH_WORKLOADS      - workloads ("true sleep big_output fail")
+#     BENCH_MODES          - 'threads' (thread per job) and/or 'event_driven' ("threads event_driven")
+#     BENCH_SLEEP          - sleep workload duration, seconds (0.01)
+#     BENCH_MAX_FAIL_JOBS  - max # of jobs for fail workload (10000)
+#     BENCH_DIR            - scratch output directory (/tmp/focus_js_bench)
+#     BENCH_RESULTS        - results csv file, appended to (./bench_results.csv)
+#
+# ie, for a quick run: BENCH_SIZES=1000 BENCH_THREADS="1 8" make bench
+
+FOCUS_JS=${FOCUS_JS:-./bin/focus_js}
+
+BENCH_SIZES=${BENCH_SIZES:-"1000 100000 1000000"}
+BENCH_THREADS=${BENCH_THREADS:-"1 4 16 64"}
+BENCH_WORKLOADS=${BENCH_WORKLOADS:-"true sleep big_output fail"}
+BENCH_MODES=${BENCH_MODES:-"threads event_driven"}
+BENCH_SLEEP=${BENCH_SLEEP:-0.01}
+BENCH_MAX_FAIL_JOBS=${BENCH_MAX_FAIL_JOBS:-10000}
+BENCH_DIR=${BENCH_DIR:-/tmp/focus_js_bench}
+BENCH_RESULTS=${BENCH_RESULTS:-./bench_results.csv}
+
+SCRIPT_DIR=`cd \`dirname $0\` && pwd`
+
+if [ ! -x "$FOCUS_JS" ]
+then
+    echo "bench: '$FOCUS_JS' not found. Build it first (make)." 1>&2
+    exit 1
+fi
+
+REVISION=`git rev-parse --short HEAD 2>/dev/null || echo unknown`
+RUN_DATE=`date +%Y-%m-%dT%H:%M:%S`
+HOST=`hostname`
+CPUS=`nproc 2>/dev/null || echo 1`
+
+if [ ! -f "$BENCH_RESULTS" ]
+then
+    echo "date,revision,host,cpus,workload,mode,threads,jobs,elapsed_seconds,jobs_per_second,time_to_first_job_ms,dispatch_p50_ms,dispatch_p99_ms,launch_mean_ms,cleanup_mean_ms,job_wall_p50_ms,focus_js_max_rss_kb,passed,failed" > "$BENCH_RESULTS"
+fi
+
+# pick a value out of the metrics file: a top-level value, or a field from one of the (single line)
+# histogram summaries...
+
+metric() {
+    sed -n "s/^  \"$1\": \([-0-9.]*\).*/\1/p" "$METRICS"
+}
+
+histogram_metric() {
+    grep "^  \"$1\":" "$METRICS" | sed -n "s/.*\"$2\": \([-0-9.]*\).*/\1/p"
+}
+
+printf "%-10s %-12s %7s %8s %10s %12s %12s %12s\n" workload mode threads jobs jobs/sec first_job_ms dispatch_p99 max_rss_kb
+
+for WORKLOAD in $BENCH_WORKLOADS
+do
+    case $WORKLOAD in
+        true)       RUN_SCRIPT=/bin/true;                        OPTIONS="" ;;
+        sleep)      RUN_SCRIPT=/bin/sleep;                       OPTIONS="$BENCH_SLEEP" ;;
+        big_output) RUN_SCRIPT=$SCRIPT_DIR/bench_big_output.sh;  OPTIONS="" ;;
+        fail)       RUN_SCRIPT=/bin/false;                       OPTIONS="" ;;
+        *)          echo "bench: unknown workload '$WORKLOAD'" 1>&2; exit 1 ;;
+    esac
+
+    for JOBS in $BENCH_SIZES
+    do
+        if [ "$WORKLOAD" = "fail" ] && [ $JOBS -gt $BENCH_MAX_FAIL_JOBS ]
+        then
+            continue
+        fi
+
+        for MODE in $BENCH_MODES
+        do
+            case $MODE in
+                threads)      MODE_OPTION="" ;;
+                event_driven) MODE_OPTION="-E" ;;
+                *)            echo "bench: unknown mode '$MODE'" 1>&2; exit 1 ;;
+            esac
+
+            for THREADS in $BENCH_THREADS
+            do
+                rm -rf "$BENCH_DIR"
+
+                if [ -n "$OPTIONS" ]
+                then
+                    $FOCUS_JS -O "$BENCH_DIR" -P bench -U $WORKLOAD -R $RUN_SCRIPT -L "$OPTIONS" -N $JOBS -T $THREADS -K $MODE_OPTION > "$BENCH_DIR.log" 2>&1
+                else
+                    $FOCUS_JS -O "$BENCH_DIR" -P bench -U $WORKLOAD -R $RUN_SCRIPT -N $JOBS -T $THREADS -K $MODE_OPTION > "$BENCH_DIR.log" 2>&1
+                fi
+
+                # (the metrics file is written periodically while jobs run; only the final version is of use)
+
+                METRICS="$BENCH_DIR/bench/metrics.json"
+
+                if ! grep -q '"final": true' "$METRICS" 2>/dev/null
+                then
+                    echo "bench: no metrics from run ($WORKLOAD, $MODE, $THREADS threads, $JOBS jobs). See $BENCH_DIR.log" 1>&2
+                    exit 1
+                fi
+
+                JOBS_PER_SECOND=`metric jobs_per_second`
+                FIRST_JOB_MS=`metric time_to_first_job_ms`
+                MAX_RSS_KB=`metric focus_js_max_rss_kb`
+                DISPATCH_P99=`histogram_metric dispatch_latency p99_ms`
+
+                echo "$RUN_DATE,$REVISION,$HOST,$CPUS,$WORKLOAD,$MODE,$THREADS,$JOBS,`metric elapsed_seconds`,$JOBS_PER_SECOND,$FIRST_JOB_MS,`histogram_metric dispatch_latency p50_ms`,$DISPATCH_P99,`histogram_metric launch_time mean_ms`,`histogram_metric cleanup_time mean_ms`,`histogram_metric job_wall_time p50_ms`,$MAX_RSS_KB,`metric passed`,`metric failed`" >> "$BENCH_RESULTS"
+
+                printf "%-10s %-12s %7s %8s %10s %12s %12s %12s\n" $WORKLOAD $MODE $THREADS $JOBS $JOBS_PER_SECOND $FIRST_JOB_MS $DISPATCH_P99 $MAX_RSS_KB
+            done
+        done
+    done
+done
+
+rm -rf "$BENCH_DIR" "$BENCH_DIR.log"
+
+echo
+echo "Results appended to: $BENCH_RESULTS"
@@ -0,0 +1,7 @@
+#!/bin/sh -f
+
+# benchmark workload - write a lot of output (1 MB to stdout, by default)...
+
+head -c ${BENCH_OUTPUT_BYTES:-1048576} /dev/zero
+
+exit 0
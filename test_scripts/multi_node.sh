@@ -0,0 +1,58 @@
+#!/bin/sh
+
+# multi_node.sh - run a sweep via a coordinator and several workers, all on this machine (each worker
+#                 could just as well run on another machine sharing the output directory). Part way
+#                 through, one worker is killed, to show that its jobs are handed out again.
+#
+# Environment variables (defaults in parens):
+#
+#     MULTI_PORT     - coordinator TCP port (7800)
+#     MULTI_WORKERS  - # of workers (3)
+#     MULTI_SLOTS    - # of jobs each worker runs at once (2)
+#     MULTI_JOBS     - # of jobs (30)
+#     MULTI_KILL     - kill one worker part way through? (yes)
+#
+# ie: MULTI_WORKERS=4 MULTI_JOBS=100 make multi
+
+FOCUS_JS=${FOCUS_JS:-./bin/focus_js}
+
+MULTI_PORT=${MULTI_PORT:-7800}
+MULTI_WORKERS=${MULTI_WORKERS:-3}
+MULTI_SLOTS=${MULTI_SLOTS:-2}
+MULTI_JOBS=${MULTI_JOBS:-30}
+MULTI_KILL=${MULTI_KILL:-yes}
+
+SCRIPT_DIR=`cd \`dirname $0\` && pwd`
+
+if [ ! -x "$FOCUS_JS" ]
+then
+    echo "multi_node: '$FOCUS_JS' not found. Build it first (make)." 1>&2
+    exit 1
+fi
+
+$FOCUS_JS -O foo -P bar -U multi -R $SCRIPT_DIR/my_dummy_script.sh -N $MULTI_JOBS -K --coordinator $MULTI_PORT &
+COORDINATOR=$!
+
+sleep 1
+
+WORKERS=""
+
+for i in `seq 1 $MULTI_WORKERS`
+do
+    $FOCUS_JS --worker localhost:$MULTI_PORT -T $MULTI_SLOTS > /dev/null &
+    WORKERS="$WORKERS $!"
+done
+
+if [ "$MULTI_KILL" = "yes" ]
+then
+    sleep 2
+    set -- $WORKERS
+    kill -9 $1
+fi
+
+wait $COORDINATOR
+RCODE=$?
+
+wait
+
+exit $RCODE